@@ -0,0 +1,5 @@
+/*------------------------
+   The sources include cnrbas.h, which is CNRBAS.H on a host with
+   case sensitive file names.
+  ------------------------*/
+#include "../CNRBAS.H"
@@ -0,0 +1,1983 @@
+/* ===================================================================*/
+/*            Basic Container Sample - host stand-in for PM           */
+/* ------------------------------------------------------------------ */
+/*                                                                    */
+/*  Functional Description:                                           */
+/*                                                                    */
+/*    This module lets the benchmark run on a host without OS/2.  It  */
+/*    implements the part of PM and of the Dos API that the sample    */
+/*    uses on top of the C library and POSIX threads: windows with a  */
+/*    window procedure and window words, one message queue that any   */
+/*    thread can post to, timers, files, event semaphores and         */
+/*    threads.                                                        */
+/*                                                                    */
+/*    WC_CONTAINER is replaced by a stand-in that keeps the records   */
+/*    in a tree and answers the messages the sample sends.  It never  */
+/*    paints, but does the work a container does with the records:    */
+/*    it allocates and frees them one by one, links and unlinks them, */
+/*    measures their text when they are inserted or their text        */
+/*    changes, sorts them and gives them icon positions.  So the      */
+/*    number of messages and the cost of each still tell which        */
+/*    approach is cheaper, even if the times are not those of PM.     */
+/*                                                                    */
+/*    Dialogs cannot be loaded, since there are no resources.         */
+/*                                                                    */
+/* ===================================================================*/
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <os2.h>
+
+#define HOST_MAX_CLASSES  8
+#define HOST_MAX_TIMERS   16
+#define HOST_MAX_THREADS  64
+
+/* Stand-in sizes, in pels, for the icon layout and text measuring. */
+#define HOST_CX_ICON      32
+#define HOST_CY_ICON      32
+#define HOST_CX_CHAR      8
+#define HOST_CY_CHAR      16
+#define HOST_CX_GAP       8
+
+/* Memory reported available by DosQuerySysInfo before any is used. */
+#define HOST_TOTAVAILMEM  0x40000000000UL
+
+typedef struct _HOSTCLASS
+{
+  CHAR        szName[32];
+  PFNWP       pfnwp;
+} HOSTCLASS;
+
+typedef struct _HOSTWND
+{
+  struct _HOSTWND *pNext;       /* Next window in the list        */
+  PFNWP       pfnwp;
+  HWND        hwndParent;
+  HWND        hwndOwner;
+  ULONG       id;
+  PVOID       pUser;            /* QWL_USER                       */
+  LONG        cx;
+  LONG        cy;
+} HOSTWND;
+typedef HOSTWND *PHOSTWND;
+
+typedef struct _HOSTTIMER
+{
+  HWND        hwnd;             /* or NULLHANDLE if the slot is   */
+  ULONG       id;               /*   free                         */
+  ULONG       ulMs;
+  ULONG       ulDueMs;
+} HOSTTIMER;
+
+typedef struct _HOSTSEM
+{
+  pthread_mutex_t mtx;
+  pthread_cond_t  cond;
+  ULONG       cPosts;           /* Posted when not 0              */
+} HOSTSEM;
+typedef HOSTSEM *PHOSTSEM;
+
+typedef struct _HOSTTHREAD
+{
+  pthread_t   thread;
+  void      (*pfn) (void *);
+  void       *pArg;
+  BOOL        fUsed;
+} HOSTTHREAD;
+
+/* Every container record is preceded by a node that links it into
+ * the tree of records.
+ */
+typedef struct _CNRNODE
+{
+  struct _CNRNODE *pParent;     /* or NULL if not inserted        */
+  struct _CNRNODE *pFirst;      /* Children                       */
+  struct _CNRNODE *pLast;
+  struct _CNRNODE *pPrev;       /* Siblings                       */
+  struct _CNRNODE *pNext;
+  ULONG       cxText;           /* Text width as last measured    */
+  ULONG       cRecs;            /* Records in this subtree        */
+} CNRNODE;
+typedef CNRNODE *PCNRNODE;
+
+#define NODEFROMREC(p)  ((PCNRNODE)(p) - 1)
+#define RECFROMNODE(p)  ((PRECORDCORE)((PCNRNODE)(p) + 1))
+
+typedef struct _HOSTCNR
+{
+  CNRNODE     Root;             /* Parent of the top level records*/
+  CNRINFO     CnrInfo;
+  PFIELDINFO  pFieldInfo;       /* Inserted columns, in order     */
+  ULONG       cSelected;        /* Records with CRA_SELECTED      */
+} HOSTCNR;
+typedef HOSTCNR *PHOSTCNR;
+
+static HOSTCLASS   aClasses[HOST_MAX_CLASSES];
+static PHOSTWND    pWndFirst;
+static HOSTTIMER   aTimers[HOST_MAX_TIMERS];
+static HOSTTHREAD  aThreads[HOST_MAX_THREADS];
+static pthread_mutex_t mtxThreads = PTHREAD_MUTEX_INITIALIZER;
+
+/* The message queue, a ring of posted messages. */
+static pthread_mutex_t mtxQueue = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  condQueue = PTHREAD_COND_INITIALIZER;
+static QMSG   *aQueue;
+static ULONG   cQueueMax;
+static ULONG   iQueueFirst;
+static ULONG   cQueue;
+
+/* The comparison given with the CM_SORTRECORD being handled. */
+static PFNRECCOMPARE pfnSortCompare;
+static PVOID         pSortStorage;
+
+static MRESULT CnrWndProc (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2);
+
+/*----------------------------------------------------------------------
+ Function Name: HostMsNow
+
+ Description:
+   Returns a monotonic time in milliseconds.
+----------------------------------------------------------------------*/
+static ULONG HostMsNow (VOID)
+{
+  struct timespec  ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ((ULONG)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: HostWnd
+
+ Description:
+   Returns the window of a handle, or NULL if the handle is not that
+   of a window that exists.
+----------------------------------------------------------------------*/
+static PHOSTWND HostWnd (HWND hwnd)
+{
+  PHOSTWND  pWnd;
+
+  for (pWnd = pWndFirst; pWnd; pWnd = pWnd->pNext)
+  {
+    if ((HWND)pWnd == hwnd)
+    {
+      return (pWnd);
+    }
+  }
+  return (NULL);
+}
+
+/* ------------------------------------------------------------------ */
+/*   Window manager                                                   */
+/* ------------------------------------------------------------------ */
+
+HAB WinInitialize (ULONG flOptions)
+{
+  return ((HAB)1);
+}
+
+BOOL WinTerminate (HAB hab)
+{
+  return (TRUE);
+}
+
+HMQ WinCreateMsgQueue (HAB hab, LONG cmsg)
+{
+  return ((HMQ)1);
+}
+
+BOOL WinDestroyMsgQueue (HMQ hmq)
+{
+  pthread_mutex_lock (&mtxQueue);
+  free (aQueue);
+  aQueue = NULL;
+  cQueueMax = iQueueFirst = cQueue = 0;
+  pthread_mutex_unlock (&mtxQueue);
+  return (TRUE);
+}
+
+BOOL WinRegisterClass (HAB hab, PCSZ pszClassName, PFNWP pfnWndProc,
+                       ULONG flStyle, ULONG cbWindowData)
+{
+  ULONG  i;
+
+  for (i = 0; i < HOST_MAX_CLASSES; i++)
+  {
+    if ((!aClasses[i].pfnwp) ||
+        (!strcmp (aClasses[i].szName, (char *)pszClassName)))
+    {
+      strncpy (aClasses[i].szName, (char *)pszClassName,
+               sizeof(aClasses[i].szName) - 1);
+      aClasses[i].pfnwp = pfnWndProc;
+      return (TRUE);
+    }
+  }
+  return (FALSE);
+}
+
+HWND WinCreateStdWindow (HWND hwndParent, ULONG flStyle,
+                         ULONG *pflCreateFlags, PCSZ pszClientClass,
+                         PCSZ pszTitle, ULONG flClientStyle,
+                         HMODULE hmod, ULONG idResources,
+                         HWND *phwndClient)
+{
+  return (NULLHANDLE);  /* There are no frame windows */
+}
+
+/*----------------------------------------------------------------------
+ Function Name: WinCreateWindow
+
+ Description:
+   Creates a window of a registered class, or a container, and sends
+   it WM_CREATE with the control data.  The window is destroyed again
+   if WM_CREATE returns TRUE; otherwise, if it has a size, it is sent
+   WM_SIZE.
+----------------------------------------------------------------------*/
+HWND WinCreateWindow (HWND hwndParent, PCSZ pszClass, PCSZ pszName,
+                      ULONG flStyle, LONG x, LONG y, LONG cx, LONG cy,
+                      HWND hwndOwner, HWND hwndInsertBehind, ULONG id,
+                      PVOID pCtlData, PVOID pPresParams)
+{
+  PHOSTWND  pWnd;
+  PFNWP     pfnwp = NULL;
+  ULONG     i;
+
+  if (pszClass == WC_CONTAINER)
+  {
+    pfnwp = CnrWndProc;
+  }
+  else
+  {
+    for (i = 0; (i < HOST_MAX_CLASSES) && (aClasses[i].pfnwp); i++)
+    {
+      if (!strcmp (aClasses[i].szName, (char *)pszClass))
+      {
+        pfnwp = aClasses[i].pfnwp;
+      }
+    }
+  }
+  if (!pfnwp)
+  {
+    return (NULLHANDLE);
+  }
+
+  pWnd = calloc (1, sizeof(HOSTWND));
+  if (!pWnd)
+  {
+    return (NULLHANDLE);
+  }
+  pWnd->pfnwp = pfnwp;
+  pWnd->hwndParent = hwndParent;
+  pWnd->hwndOwner = hwndOwner;
+  pWnd->id = id;
+  pWnd->cx = cx;
+  pWnd->cy = cy;
+  pWnd->pNext = pWndFirst;
+  pWndFirst = pWnd;
+
+  if (pfnwp ((HWND)pWnd, WM_CREATE, pCtlData, NULL))
+  {
+    WinDestroyWindow ((HWND)pWnd);
+    return (NULLHANDLE);
+  }
+  if ((cx) || (cy))
+  {
+    pfnwp ((HWND)pWnd, WM_SIZE, MPFROM2SHORT(0, 0),
+           MPFROM2SHORT(cx, cy));
+  }
+  return ((HWND)pWnd);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: WinDestroyWindow
+
+ Description:
+   Sends WM_DESTROY to a window and then destroys its children.  Its
+   timers and the messages posted to it go with it.
+----------------------------------------------------------------------*/
+BOOL WinDestroyWindow (HWND hwnd)
+{
+  PHOSTWND  pWnd;
+  PHOSTWND *ppWnd;
+  PHOSTWND  pChild;
+  ULONG     i;
+  ULONG     j;
+
+  pWnd = HostWnd (hwnd);
+  if (!pWnd)
+  {
+    return (FALSE);
+  }
+
+  pWnd->pfnwp (hwnd, WM_DESTROY, NULL, NULL);
+
+  do
+  {
+    for (pChild = pWndFirst; pChild; pChild = pChild->pNext)
+    {
+      if (pChild->hwndParent == hwnd)
+      {
+        WinDestroyWindow ((HWND)pChild);
+        break;
+      }
+    }
+  } while (pChild);
+
+  for (i = 0; i < HOST_MAX_TIMERS; i++)
+  {
+    if (aTimers[i].hwnd == hwnd)
+    {
+      aTimers[i].hwnd = NULLHANDLE;
+    }
+  }
+
+  pthread_mutex_lock (&mtxQueue);
+  for (i = j = 0; i < cQueue; i++)
+  {
+    if (aQueue[(iQueueFirst + i) % cQueueMax].hwnd != hwnd)
+    {
+      aQueue[(iQueueFirst + j++) % cQueueMax] =
+        aQueue[(iQueueFirst + i) % cQueueMax];
+    }
+  }
+  cQueue = j;
+  pthread_mutex_unlock (&mtxQueue);
+
+  for (ppWnd = &pWndFirst; *ppWnd != pWnd; ppWnd = &(*ppWnd)->pNext)
+  {
+  }
+  *ppWnd = pWnd->pNext;
+  free (pWnd);
+  return (TRUE);
+}
+
+HWND WinWindowFromID (HWND hwndParent, ULONG id)
+{
+  PHOSTWND  pWnd;
+
+  for (pWnd = pWndFirst; pWnd; pWnd = pWnd->pNext)
+  {
+    if ((pWnd->hwndParent == hwndParent) && (pWnd->id == id))
+    {
+      return ((HWND)pWnd);
+    }
+  }
+  return (NULLHANDLE);
+}
+
+HWND WinQueryWindow (HWND hwnd, LONG cmd)
+{
+  PHOSTWND  pWnd = HostWnd (hwnd);
+
+  if (!pWnd)
+  {
+    return (NULLHANDLE);
+  }
+  return ((cmd == QW_OWNER) ? pWnd->hwndOwner :
+          (cmd == QW_PARENT) ? pWnd->hwndParent : NULLHANDLE);
+}
+
+HAB WinQueryAnchorBlock (HWND hwnd)
+{
+  return ((HAB)1);
+}
+
+PVOID WinQueryWindowPtr (HWND hwnd, LONG index)
+{
+  PHOSTWND  pWnd = HostWnd (hwnd);
+
+  return ((pWnd) ? pWnd->pUser : NULL);
+}
+
+BOOL WinSetWindowPtr (HWND hwnd, LONG index, PVOID p)
+{
+  PHOSTWND  pWnd = HostWnd (hwnd);
+
+  if (!pWnd)
+  {
+    return (FALSE);
+  }
+  pWnd->pUser = p;
+  return (TRUE);
+}
+
+BOOL WinQueryWindowRect (HWND hwnd, PRECTL prcl)
+{
+  PHOSTWND  pWnd = HostWnd (hwnd);
+
+  if (!pWnd)
+  {
+    return (FALSE);
+  }
+  prcl->xLeft = prcl->yBottom = 0;
+  prcl->xRight = pWnd->cx;
+  prcl->yTop = pWnd->cy;
+  return (TRUE);
+}
+
+BOOL WinSetMultWindowPos (HAB hab, PSWP pswp, ULONG cswp)
+{
+  PHOSTWND  pWnd;
+  ULONG     i;
+
+  for (i = 0; i < cswp; i++)
+  {
+    pWnd = HostWnd (pswp[i].hwnd);
+    if ((pWnd) && (pswp[i].fl & SWP_SIZE))
+    {
+      pWnd->cx = pswp[i].cx;
+      pWnd->cy = pswp[i].cy;
+    }
+  }
+  return (TRUE);
+}
+
+BOOL WinSetFocus (HWND hwndDesktop, HWND hwndFocus)
+{
+  return (TRUE);
+}
+
+BOOL WinUpdateWindow (HWND hwnd)
+{
+  return (TRUE);  /* Nothing is ever painted */
+}
+
+MRESULT WinSendMsg (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2)
+{
+  PHOSTWND  pWnd = HostWnd (hwnd);
+
+  return ((pWnd) ? pWnd->pfnwp (hwnd, msg, mp1, mp2) : NULL);
+}
+
+MRESULT WinDefWindowProc (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2)
+{
+  return (NULL);
+}
+
+/* ------------------------------------------------------------------ */
+/*   Message queue and timers                                         */
+/* ------------------------------------------------------------------ */
+
+/*----------------------------------------------------------------------
+ Function Name: WinPostMsg
+
+ Description:
+   Adds a message to the end of the queue.  Any thread may post; the
+   ring doubles when it is full.
+----------------------------------------------------------------------*/
+BOOL WinPostMsg (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2)
+{
+  QMSG   *aNew;
+  ULONG   cMax;
+  ULONG   i;
+  QMSG   *pqmsg;
+
+  pthread_mutex_lock (&mtxQueue);
+  if (cQueue == cQueueMax)
+  {
+    cMax = (cQueueMax) ? cQueueMax * 2 : 64;
+    aNew = malloc (cMax * sizeof(QMSG));
+    if (!aNew)
+    {
+      pthread_mutex_unlock (&mtxQueue);
+      return (FALSE);
+    }
+    for (i = 0; i < cQueue; i++)
+    {
+      aNew[i] = aQueue[(iQueueFirst + i) % cQueueMax];
+    }
+    free (aQueue);
+    aQueue = aNew;
+    cQueueMax = cMax;
+    iQueueFirst = 0;
+  }
+
+  pqmsg = &aQueue[(iQueueFirst + cQueue++) % cQueueMax];
+  memset (pqmsg, 0, sizeof(QMSG));
+  pqmsg->hwnd = hwnd;
+  pqmsg->msg = msg;
+  pqmsg->mp1 = mp1;
+  pqmsg->mp2 = mp2;
+  pqmsg->time = HostMsNow ();
+  pthread_cond_signal (&condQueue);
+  pthread_mutex_unlock (&mtxQueue);
+  return (TRUE);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: QueryMsg
+
+ Description:
+   Takes the first posted message off the queue, or makes a WM_TIMER
+   for a timer that is due if nothing is posted.  Called with the
+   queue locked.
+
+ Parameters:
+   (PQMSG) pqmsg    - Receives the message.
+   (BOOL)  fRemove  - Take the message off the queue.
+   (PULONG) pulWait - Receives the milliseconds until the next timer is
+                      due, or SEM_INDEFINITE_WAIT if there is none.
+
+ Return Values:
+   (BOOL)  TRUE  - A message was returned.
+           FALSE - There is none.
+----------------------------------------------------------------------*/
+static BOOL QueryMsg (PQMSG pqmsg, BOOL fRemove, PULONG pulWait)
+{
+  ULONG  ulNow;
+  ULONG  i;
+
+  *pulWait = SEM_INDEFINITE_WAIT;
+  if (cQueue)
+  {
+    *pqmsg = aQueue[iQueueFirst];
+    if (fRemove)
+    {
+      iQueueFirst = (iQueueFirst + 1) % cQueueMax;
+      cQueue--;
+    }
+    return (TRUE);
+  }
+
+  ulNow = HostMsNow ();
+  for (i = 0; i < HOST_MAX_TIMERS; i++)
+  {
+    if (!aTimers[i].hwnd)
+    {
+      continue;
+    }
+    if ((LONG)(ulNow - aTimers[i].ulDueMs) >= 0)
+    {
+      memset (pqmsg, 0, sizeof(QMSG));
+      pqmsg->hwnd = aTimers[i].hwnd;
+      pqmsg->msg = WM_TIMER;
+      pqmsg->mp1 = MPFROMSHORT(aTimers[i].id);
+      pqmsg->time = ulNow;
+      if (fRemove)
+      {
+        aTimers[i].ulDueMs = ulNow + aTimers[i].ulMs;
+      }
+      return (TRUE);
+    }
+    if (aTimers[i].ulDueMs - ulNow < *pulWait)
+    {
+      *pulWait = aTimers[i].ulDueMs - ulNow;
+    }
+  }
+  return (FALSE);
+}
+
+BOOL WinGetMsg (HAB hab, PQMSG pqmsg, HWND hwndFilter,
+                ULONG msgFilterFirst, ULONG msgFilterLast)
+{
+  struct timespec  ts;
+  ULONG            ulWait;
+
+  pthread_mutex_lock (&mtxQueue);
+  while (!QueryMsg (pqmsg, TRUE, &ulWait))
+  {
+    if (ulWait == SEM_INDEFINITE_WAIT)
+    {
+      pthread_cond_wait (&condQueue, &mtxQueue);
+    }
+    else
+    {
+      clock_gettime (CLOCK_REALTIME, &ts);
+      ts.tv_sec += ulWait / 1000;
+      ts.tv_nsec += (ulWait % 1000) * 1000000;
+      if (ts.tv_nsec >= 1000000000)
+      {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+      }
+      pthread_cond_timedwait (&condQueue, &mtxQueue, &ts);
+    }
+  }
+  pthread_mutex_unlock (&mtxQueue);
+  return (pqmsg->msg != WM_QUIT);
+}
+
+BOOL WinPeekMsg (HAB hab, PQMSG pqmsg, HWND hwndFilter,
+                 ULONG msgFilterFirst, ULONG msgFilterLast, ULONG fl)
+{
+  ULONG  ulWait;
+  BOOL   fMsg;
+
+  pthread_mutex_lock (&mtxQueue);
+  fMsg = QueryMsg (pqmsg, (fl & PM_REMOVE) != 0, &ulWait);
+  pthread_mutex_unlock (&mtxQueue);
+  return (fMsg);
+}
+
+MRESULT WinDispatchMsg (HAB hab, PQMSG pqmsg)
+{
+  return (WinSendMsg (pqmsg->hwnd, pqmsg->msg, pqmsg->mp1, pqmsg->mp2));
+}
+
+ULONG WinStartTimer (HAB hab, HWND hwnd, ULONG idTimer, ULONG dtTimeout)
+{
+  ULONG  iFree = HOST_MAX_TIMERS;
+  ULONG  i;
+
+  pthread_mutex_lock (&mtxQueue);
+  for (i = 0; i < HOST_MAX_TIMERS; i++)
+  {
+    if ((aTimers[i].hwnd == hwnd) && (aTimers[i].id == idTimer))
+    {
+      iFree = i;
+      break;
+    }
+    if ((!aTimers[i].hwnd) && (iFree == HOST_MAX_TIMERS))
+    {
+      iFree = i;
+    }
+  }
+  if (iFree < HOST_MAX_TIMERS)
+  {
+    aTimers[iFree].hwnd = hwnd;
+    aTimers[iFree].id = idTimer;
+    aTimers[iFree].ulMs = dtTimeout;
+    aTimers[iFree].ulDueMs = HostMsNow () + dtTimeout;
+  }
+  pthread_cond_signal (&condQueue);
+  pthread_mutex_unlock (&mtxQueue);
+  return ((iFree < HOST_MAX_TIMERS) ? idTimer : 0);
+}
+
+BOOL WinStopTimer (HAB hab, HWND hwnd, ULONG idTimer)
+{
+  ULONG  i;
+
+  pthread_mutex_lock (&mtxQueue);
+  for (i = 0; i < HOST_MAX_TIMERS; i++)
+  {
+    if ((aTimers[i].hwnd == hwnd) && (aTimers[i].id == idTimer))
+    {
+      aTimers[i].hwnd = NULLHANDLE;
+    }
+  }
+  pthread_mutex_unlock (&mtxQueue);
+  return (TRUE);
+}
+
+/* ------------------------------------------------------------------ */
+/*   Painting, pointers, dialogs                                      */
+/* ------------------------------------------------------------------ */
+
+HPS WinBeginPaint (HWND hwnd, HPS hps, PRECTL prclPaint)
+{
+  if (prclPaint)
+  {
+    WinQueryWindowRect (hwnd, prclPaint);
+  }
+  return ((HPS)1);
+}
+
+BOOL WinFillRect (HPS hps, PRECTL prcl, LONG lColor)
+{
+  return (TRUE);
+}
+
+BOOL WinEndPaint (HPS hps)
+{
+  return (TRUE);
+}
+
+HPOINTER WinLoadPointer (HWND hwndDesktop, HMODULE hmod, ULONG idres)
+{
+  return ((HPOINTER)idres);
+}
+
+BOOL WinDestroyPointer (HPOINTER hptr)
+{
+  return (TRUE);
+}
+
+ULONG WinUpperChar (HAB hab, ULONG idcp, ULONG idcc, ULONG c)
+{
+  return ((ULONG)toupper ((int)c));
+}
+
+BOOL WinAlarm (HWND hwndDesktop, ULONG rgfType)
+{
+  return (TRUE);
+}
+
+HWND WinLoadDlg (HWND hwndParent, HWND hwndOwner, PFNWP pfnDlgProc,
+                 HMODULE hmod, ULONG idDlg, PVOID pCreateParams)
+{
+  return (NULLHANDLE);  /* There are no resources to load it from */
+}
+
+MRESULT WinDefDlgProc (HWND hwndDlg, ULONG msg, MPARAM mp1, MPARAM mp2)
+{
+  return (NULL);
+}
+
+ULONG WinQueryDlgItemText (HWND hwndDlg, ULONG idItem, LONG cchBufferMax,
+                           PSZ pchBuffer)
+{
+  if (cchBufferMax > 0)
+  {
+    *pchBuffer = '\0';
+  }
+  return (0);
+}
+
+MRESULT WinSendDlgItemMsg (HWND hwndDlg, ULONG idItem, ULONG msg,
+                           MPARAM mp1, MPARAM mp2)
+{
+  return (WinSendMsg (WinWindowFromID (hwndDlg, idItem), msg, mp1, mp2));
+}
+
+/* ------------------------------------------------------------------ */
+/*   Files                                                            */
+/* ------------------------------------------------------------------ */
+
+/*----------------------------------------------------------------------
+ Function Name: StatToStatus
+
+ Description:
+   Fills a FILESTATUS3 from the status of a file.
+----------------------------------------------------------------------*/
+static VOID StatToStatus (struct stat *pst, FILESTATUS3 *pfs3)
+{
+  struct tm  tm;
+
+  memset (pfs3, 0, sizeof(FILESTATUS3));
+  localtime_r (&pst->st_mtime, &tm);
+  pfs3->fdateLastWrite.day = tm.tm_mday;
+  pfs3->fdateLastWrite.month = tm.tm_mon + 1;
+  pfs3->fdateLastWrite.year = tm.tm_year - 80;
+  pfs3->ftimeLastWrite.twosecs = tm.tm_sec / 2;
+  pfs3->ftimeLastWrite.minutes = tm.tm_min;
+  pfs3->ftimeLastWrite.hours = tm.tm_hour;
+  pfs3->fdateCreation = pfs3->fdateLastAccess = pfs3->fdateLastWrite;
+  pfs3->ftimeCreation = pfs3->ftimeLastAccess = pfs3->ftimeLastWrite;
+  pfs3->cbFile = pst->st_size;
+  pfs3->cbFileAlloc = pst->st_blocks * 512;
+}
+
+APIRET DosOpen (PCSZ pszFileName, PHFILE phf, PULONG pulAction,
+                ULONG cbFile, ULONG ulAttribute, ULONG fsOpenFlags,
+                ULONG fsOpenMode, PVOID peaop2)
+{
+  int  oflag;
+  int  fd;
+
+  switch (fsOpenMode & 3)
+  {
+    case OPEN_ACCESS_WRITEONLY:
+      oflag = O_WRONLY;
+    break;
+
+    case OPEN_ACCESS_READWRITE:
+      oflag = O_RDWR;
+    break;
+
+    default:
+      oflag = O_RDONLY;
+    break;
+  }
+  if (fsOpenFlags & OPEN_ACTION_CREATE_IF_NEW)
+  {
+    oflag |= O_CREAT;
+  }
+  if (fsOpenFlags & OPEN_ACTION_REPLACE_IF_EXISTS)
+  {
+    oflag |= O_TRUNC;
+  }
+  else if (!(fsOpenFlags & OPEN_ACTION_OPEN_IF_EXISTS))
+  {
+    oflag |= O_EXCL;
+  }
+
+  fd = open ((char *)pszFileName, oflag, 0666);
+  if (fd == -1)
+  {
+    return ((errno == ENOENT) ? 2 : 110);  /* File not found, open failed */
+  }
+  *phf = (HFILE)fd;
+  *pulAction = 1;
+  return (0);
+}
+
+APIRET DosRead (HFILE hf, PVOID pBuffer, ULONG cbRead, PULONG pcbActual)
+{
+  ssize_t  cb;
+
+  *pcbActual = 0;
+  while (*pcbActual < cbRead)
+  {
+    cb = read ((int)hf, (char *)pBuffer + *pcbActual, cbRead - *pcbActual);
+    if (cb < 0)
+    {
+      return (5);
+    }
+    if (!cb)
+    {
+      break;
+    }
+    *pcbActual += cb;
+  }
+  return (0);
+}
+
+APIRET DosWrite (HFILE hf, PVOID pBuffer, ULONG cbWrite, PULONG pcbActual)
+{
+  ssize_t  cb;
+
+  *pcbActual = 0;
+  while (*pcbActual < cbWrite)
+  {
+    cb = write ((int)hf, (char *)pBuffer + *pcbActual,
+                cbWrite - *pcbActual);
+    if (cb <= 0)
+    {
+      return (5);
+    }
+    *pcbActual += cb;
+  }
+  return (0);
+}
+
+APIRET DosClose (HFILE hf)
+{
+  return ((close ((int)hf)) ? 6 : 0);
+}
+
+APIRET DosQueryFileInfo (HFILE hf, ULONG ulInfoLevel, PVOID pInfo,
+                         ULONG cbInfoBuf)
+{
+  struct stat  st;
+
+  if ((cbInfoBuf < sizeof(FILESTATUS3)) || (fstat ((int)hf, &st)))
+  {
+    return (87);
+  }
+  StatToStatus (&st, pInfo);
+  return (0);
+}
+
+APIRET DosQueryPathInfo (PCSZ pszPathName, ULONG ulInfoLevel, PVOID pInfo,
+                         ULONG cbInfoBuf)
+{
+  struct stat  st;
+
+  if (cbInfoBuf < sizeof(FILESTATUS3))
+  {
+    return (87);
+  }
+  if (stat ((char *)pszPathName, &st))
+  {
+    return (2);
+  }
+  StatToStatus (&st, pInfo);
+  return (0);
+}
+
+APIRET DosDelete (PCSZ pszFile)
+{
+  return ((unlink ((char *)pszFile)) ? 2 : 0);
+}
+
+/* ------------------------------------------------------------------ */
+/*   Memory, timers and system information                            */
+/* ------------------------------------------------------------------ */
+
+APIRET DosAllocMem (PPVOID ppb, ULONG cb, ULONG flag)
+{
+  *ppb = malloc (cb);
+  return ((*ppb) ? 0 : 8);
+}
+
+APIRET DosFreeMem (PVOID pb)
+{
+  free (pb);
+  return (0);
+}
+
+APIRET DosTmrQueryFreq (PULONG pulTmrFreq)
+{
+  *pulTmrFreq = 1000000;
+  return (0);
+}
+
+APIRET DosTmrQueryTime (PQWORD pqwTmrTime)
+{
+  struct timespec  ts;
+  ULONG            ulUs;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  ulUs = (ULONG)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+  pqwTmrTime->ulLo = ulUs & 0xFFFFFFFFUL;
+  pqwTmrTime->ulHi = ulUs >> 32;
+  return (0);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: DosQuerySysInfo
+
+ Description:
+   Only QSV_TOTAVAILMEM is known.  It is given as a fixed amount less
+   the heap the process has in use, so that the change between two
+   calls is the memory the process took or gave back, without the
+   noise of the other processes.
+----------------------------------------------------------------------*/
+APIRET DosQuerySysInfo (ULONG iStart, ULONG iLast, PVOID pBuf, ULONG cbBuf)
+{
+  struct mallinfo2  mi;
+
+  if ((iStart != QSV_TOTAVAILMEM) || (cbBuf < sizeof(ULONG)))
+  {
+    return (87);
+  }
+  mi = mallinfo2 ();
+  *(PULONG)pBuf = HOST_TOTAVAILMEM - mi.uordblks - mi.hblkhd;
+  return (0);
+}
+
+/* ------------------------------------------------------------------ */
+/*   Threads and semaphores                                           */
+/* ------------------------------------------------------------------ */
+
+APIRET DosCreateEventSem (PCSZ pszName, PHEV phev, ULONG flAttr,
+                          BOOL fState)
+{
+  PHOSTSEM  pSem;
+
+  pSem = malloc (sizeof(HOSTSEM));
+  if (!pSem)
+  {
+    return (8);
+  }
+  pthread_mutex_init (&pSem->mtx, NULL);
+  pthread_cond_init (&pSem->cond, NULL);
+  pSem->cPosts = (fState) ? 1 : 0;
+  *phev = (HEV)pSem;
+  return (0);
+}
+
+APIRET DosCloseEventSem (HEV hev)
+{
+  PHOSTSEM  pSem = (PHOSTSEM)hev;
+
+  pthread_cond_destroy (&pSem->cond);
+  pthread_mutex_destroy (&pSem->mtx);
+  free (pSem);
+  return (0);
+}
+
+APIRET DosPostEventSem (HEV hev)
+{
+  PHOSTSEM  pSem = (PHOSTSEM)hev;
+
+  pthread_mutex_lock (&pSem->mtx);
+  pSem->cPosts++;
+  pthread_cond_broadcast (&pSem->cond);
+  pthread_mutex_unlock (&pSem->mtx);
+  return (0);
+}
+
+APIRET DosResetEventSem (HEV hev, PULONG pulPostCt)
+{
+  PHOSTSEM  pSem = (PHOSTSEM)hev;
+
+  pthread_mutex_lock (&pSem->mtx);
+  *pulPostCt = pSem->cPosts;
+  pSem->cPosts = 0;
+  pthread_mutex_unlock (&pSem->mtx);
+  return ((*pulPostCt) ? 0 : 300);  /* ERROR_ALREADY_RESET */
+}
+
+APIRET DosWaitEventSem (HEV hev, ULONG ulTimeout)
+{
+  PHOSTSEM         pSem = (PHOSTSEM)hev;
+  struct timespec  ts;
+  APIRET           rc = 0;
+
+  clock_gettime (CLOCK_REALTIME, &ts);
+  if (ulTimeout != SEM_INDEFINITE_WAIT)
+  {
+    ts.tv_sec += ulTimeout / 1000;
+    ts.tv_nsec += (ulTimeout % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000)
+    {
+      ts.tv_sec++;
+      ts.tv_nsec -= 1000000000;
+    }
+  }
+
+  pthread_mutex_lock (&pSem->mtx);
+  while ((!pSem->cPosts) && (!rc))
+  {
+    if (ulTimeout == SEM_INDEFINITE_WAIT)
+    {
+      pthread_cond_wait (&pSem->cond, &pSem->mtx);
+    }
+    else if (pthread_cond_timedwait (&pSem->cond, &pSem->mtx, &ts) ==
+             ETIMEDOUT)
+    {
+      rc = 640;  /* ERROR_TIMEOUT */
+    }
+  }
+  pthread_mutex_unlock (&pSem->mtx);
+  return (rc);
+}
+
+static void *ThreadMain (void *pv)
+{
+  HOSTTHREAD  *pThread = pv;
+
+  pThread->pfn (pThread->pArg);
+  return (NULL);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: _beginthread
+
+ Description:
+   Starts a thread.  The stack arguments are ignored.
+
+ Return Values:
+   (int) - The thread id, or -1 on an error.
+----------------------------------------------------------------------*/
+int _beginthread (void (*start) (void *), void *stack, unsigned stack_size,
+                  void *arg)
+{
+  ULONG  i;
+  int    tid = -1;
+
+  pthread_mutex_lock (&mtxThreads);
+  for (i = 0; i < HOST_MAX_THREADS; i++)
+  {
+    if (!aThreads[i].fUsed)
+    {
+      aThreads[i].pfn = start;
+      aThreads[i].pArg = arg;
+      if (!pthread_create (&aThreads[i].thread, NULL, ThreadMain,
+                           &aThreads[i]))
+      {
+        aThreads[i].fUsed = TRUE;
+        tid = (int)i + 1;
+      }
+      break;
+    }
+  }
+  pthread_mutex_unlock (&mtxThreads);
+  return (tid);
+}
+
+APIRET DosWaitThread (PTID ptid, ULONG option)
+{
+  ULONG  i = *ptid - 1;
+
+  if ((*ptid < 1) || (*ptid > HOST_MAX_THREADS) || (!aThreads[i].fUsed))
+  {
+    return (309);  /* ERROR_INVALID_THREADID */
+  }
+  pthread_join (aThreads[i].thread, NULL);
+  pthread_mutex_lock (&mtxThreads);
+  aThreads[i].fUsed = FALSE;
+  pthread_mutex_unlock (&mtxThreads);
+  return (0);
+}
+
+APIRET DosSleep (ULONG msec)
+{
+  struct timespec  ts;
+
+  ts.tv_sec = msec / 1000;
+  ts.tv_nsec = (msec % 1000) * 1000000;
+  nanosleep (&ts, NULL);
+  return (0);
+}
+
+/* ------------------------------------------------------------------ */
+/*   Container stand-in                                               */
+/* ------------------------------------------------------------------ */
+
+/*----------------------------------------------------------------------
+ Function Name: MeasureRecord
+
+ Description:
+   Measures the text of a record, as the container does to lay it
+   out: the widest line of pszIcon.
+----------------------------------------------------------------------*/
+static VOID MeasureRecord (PCNRNODE pNode)
+{
+  PSZ    psz = RECFROMNODE(pNode)->pszIcon;
+  ULONG  cch = 0;
+  ULONG  cchMax = 0;
+
+  for (; (psz) && (*psz); psz++)
+  {
+    if ((*psz == '\r') || (*psz == '\n'))
+    {
+      cch = 0;
+    }
+    else if (++cch > cchMax)
+    {
+      cchMax = cch;
+    }
+  }
+  pNode->cxText = cchMax * HOST_CX_CHAR;
+}
+
+/*----------------------------------------------------------------------
+ Function Name: NextNode
+
+ Description:
+   Returns the record after a record in item order, walking the tree
+   depth first, or NULL after the last one.
+----------------------------------------------------------------------*/
+static PCNRNODE NextNode (PHOSTCNR pCnr, PCNRNODE pNode)
+{
+  if (pNode->pFirst)
+  {
+    return (pNode->pFirst);
+  }
+  while ((pNode != &pCnr->Root) && (!pNode->pNext))
+  {
+    pNode = pNode->pParent;
+  }
+  return ((pNode == &pCnr->Root) ? NULL : pNode->pNext);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: NextShownNode
+
+ Description:
+   Returns the record after a record in the order they are shown in
+   the views other than Icon view, where the children of a record are
+   only shown while it is expanded, or NULL after the last one.
+----------------------------------------------------------------------*/
+static PCNRNODE NextShownNode (PHOSTCNR pCnr, PCNRNODE pNode)
+{
+  if ((pNode->pFirst) &&
+      (RECFROMNODE(pNode)->flRecordAttr & CRA_EXPANDED))
+  {
+    return (pNode->pFirst);
+  }
+  while ((pNode != &pCnr->Root) && (!pNode->pNext))
+  {
+    pNode = pNode->pParent;
+  }
+  return ((pNode == &pCnr->Root) ? NULL : pNode->pNext);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: FreeNodes
+
+ Description:
+   Frees a record and the records under it.
+----------------------------------------------------------------------*/
+static VOID FreeNodes (PHOSTCNR pCnr, PCNRNODE pNode)
+{
+  PCNRNODE  pChild;
+  PCNRNODE  pNext;
+
+  for (pChild = pNode->pFirst; pChild; pChild = pNext)
+  {
+    pNext = pChild->pNext;
+    FreeNodes (pCnr, pChild);
+  }
+  free (pNode);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: CountSelected
+
+ Description:
+   Returns how many of a record and the records under it have
+   CRA_SELECTED.
+----------------------------------------------------------------------*/
+static ULONG CountSelected (PCNRNODE pNode)
+{
+  PCNRNODE  pChild;
+  ULONG     c;
+
+  c = (RECFROMNODE(pNode)->flRecordAttr & CRA_SELECTED) ? 1 : 0;
+  for (pChild = pNode->pFirst; pChild; pChild = pChild->pNext)
+  {
+    c += CountSelected (pChild);
+  }
+  return (c);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: UnlinkNode
+
+ Description:
+   Takes a record, with the records under it, out of the tree.
+----------------------------------------------------------------------*/
+static VOID UnlinkNode (PHOSTCNR pCnr, PCNRNODE pNode)
+{
+  PCNRNODE  pParent = pNode->pParent;
+  PCNRNODE  pUp;
+
+  if (pNode->pPrev)
+  {
+    pNode->pPrev->pNext = pNode->pNext;
+  }
+  else
+  {
+    pParent->pFirst = pNode->pNext;
+  }
+  if (pNode->pNext)
+  {
+    pNode->pNext->pPrev = pNode->pPrev;
+  }
+  else
+  {
+    pParent->pLast = pNode->pPrev;
+  }
+  for (pUp = pParent; pUp; pUp = pUp->pParent)
+  {
+    pUp->cRecs -= pNode->cRecs;
+  }
+  pCnr->cSelected -= CountSelected (pNode);
+  pNode->pParent = pNode->pPrev = pNode->pNext = NULL;
+}
+
+/*----------------------------------------------------------------------
+ Function Name: AllocRecords
+
+ Description:
+   CM_ALLOCRECORD: allocates a chain of zeroed records, each with
+   cbExtra bytes after its MINIRECORDCORE.
+----------------------------------------------------------------------*/
+static PRECORDCORE AllocRecords (ULONG cbExtra, ULONG cRecs)
+{
+  PCNRNODE     pNode;
+  PRECORDCORE  pRec;
+  PRECORDCORE  pRecFirst = NULL;
+  PRECORDCORE  pRecLast = NULL;
+  ULONG        i;
+
+  for (i = 0; i < cRecs; i++)
+  {
+    pNode = calloc (1, sizeof(CNRNODE) + sizeof(MINIRECORDCORE) + cbExtra);
+    if (!pNode)
+    {
+      while (pRecFirst)
+      {
+        pRec = pRecFirst->preccNextRecord;
+        free (NODEFROMREC(pRecFirst));
+        pRecFirst = pRec;
+      }
+      return (NULL);
+    }
+    pNode->cRecs = 1;
+    pRec = RECFROMNODE(pNode);
+    pRec->cb = sizeof(MINIRECORDCORE);
+    if (pRecLast)
+    {
+      pRecLast->preccNextRecord = pRec;
+    }
+    else
+    {
+      pRecFirst = pRec;
+    }
+    pRecLast = pRec;
+  }
+  return (pRecFirst);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: InsertRecords
+
+ Description:
+   CM_INSERTRECORD: links cRecordsInsert records of a chain under their
+   parent, first, last or after a given record, and measures their
+   text.
+
+ Return Values:
+   (ULONG) - The number of records in the container, or 0 on an
+             error.
+----------------------------------------------------------------------*/
+static ULONG InsertRecords (PHOSTCNR pCnr, PRECORDCORE pRec,
+                            PRECORDINSERT pRecordInsert)
+{
+  PCNRNODE  pParent;
+  PCNRNODE  pAfter;
+  PCNRNODE  pNode;
+  PCNRNODE  pUp;
+  ULONG     i;
+
+  pParent = (pRecordInsert->pRecordParent) ?
+            NODEFROMREC(pRecordInsert->pRecordParent) : &pCnr->Root;
+  if (pRecordInsert->pRecordOrder == (PRECORDCORE)CMA_FIRST)
+  {
+    pAfter = NULL;
+  }
+  else if (pRecordInsert->pRecordOrder == (PRECORDCORE)CMA_END)
+  {
+    pAfter = pParent->pLast;
+  }
+  else
+  {
+    pAfter = NODEFROMREC(pRecordInsert->pRecordOrder);
+    if (pAfter->pParent != pParent)
+    {
+      return (0);
+    }
+  }
+
+  for (i = 0; (pRec) && (i < pRecordInsert->cRecordsInsert); i++)
+  {
+    pNode = NODEFROMREC(pRec);
+    if (pNode->pParent)
+    {
+      return (0);  /* Already inserted */
+    }
+    pNode->pParent = pParent;
+    pNode->pPrev = pAfter;
+    pNode->pNext = (pAfter) ? pAfter->pNext : pParent->pFirst;
+    if (pNode->pPrev)
+    {
+      pNode->pPrev->pNext = pNode;
+    }
+    else
+    {
+      pParent->pFirst = pNode;
+    }
+    if (pNode->pNext)
+    {
+      pNode->pNext->pPrev = pNode;
+    }
+    else
+    {
+      pParent->pLast = pNode;
+    }
+    for (pUp = pParent; pUp; pUp = pUp->pParent)
+    {
+      pUp->cRecs += pNode->cRecs;
+    }
+    pCnr->cSelected += CountSelected (pNode);
+    MeasureRecord (pNode);
+    pAfter = pNode;
+    pRec = pRec->preccNextRecord;
+  }
+  return (pCnr->Root.cRecs);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: RemoveRecords
+
+ Description:
+   CM_REMOVERECORD: takes records, with the records under them, out of
+   the tree, and with CMA_FREE frees them.  A count of 0 removes every
+   record.
+
+ Return Values:
+   (ULONG) - The number of records left in the container.
+----------------------------------------------------------------------*/
+static ULONG RemoveRecords (PHOSTCNR pCnr, PRECORDCORE *apRecs,
+                            ULONG cRecs, ULONG fl)
+{
+  PCNRNODE  pNode;
+  ULONG     i;
+
+  if (!cRecs)
+  {
+    while ((pNode = pCnr->Root.pFirst) != NULL)
+    {
+      UnlinkNode (pCnr, pNode);
+      if (fl & CMA_FREE)
+      {
+        FreeNodes (pCnr, pNode);
+      }
+    }
+    return (0);
+  }
+
+  for (i = 0; i < cRecs; i++)
+  {
+    pNode = NODEFROMREC(apRecs[i]);
+    if (pNode->pParent)
+    {
+      UnlinkNode (pCnr, pNode);
+      if (fl & CMA_FREE)
+      {
+        FreeNodes (pCnr, pNode);
+      }
+    }
+  }
+  return (pCnr->Root.cRecs);
+}
+
+static int SortCompare (const void *pv1, const void *pv2)
+{
+  return (pfnSortCompare (RECFROMNODE(*(PCNRNODE *)pv1),
+                          RECFROMNODE(*(PCNRNODE *)pv2), pSortStorage));
+}
+
+/*----------------------------------------------------------------------
+ Function Name: SortChildren
+
+ Description:
+   CM_SORTRECORD: sorts the records under a parent, and the records
+   under each of those, with the comparison in pfnSortCompare.
+
+ Parameters:
+   (PCNRNODE)   pParent - The parent.
+   (PCNRNODE *) apNodes - Room for as many records as the container
+                          has.
+----------------------------------------------------------------------*/
+static VOID SortChildren (PCNRNODE pParent, PCNRNODE *apNodes)
+{
+  PCNRNODE  pNode;
+  ULONG     cNodes = 0;
+  ULONG     i;
+
+  for (pNode = pParent->pFirst; pNode; pNode = pNode->pNext)
+  {
+    apNodes[cNodes++] = pNode;
+  }
+  if (cNodes > 1)
+  {
+    qsort (apNodes, cNodes, sizeof(PCNRNODE), SortCompare);
+    for (i = 0; i < cNodes; i++)
+    {
+      apNodes[i]->pPrev = (i) ? apNodes[i - 1] : NULL;
+      apNodes[i]->pNext = (i + 1 < cNodes) ? apNodes[i + 1] : NULL;
+    }
+    pParent->pFirst = apNodes[0];
+    pParent->pLast = apNodes[cNodes - 1];
+  }
+
+  for (pNode = pParent->pFirst; pNode; pNode = pNode->pNext)
+  {
+    if (pNode->pFirst)
+    {
+      SortChildren (pNode, apNodes);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+ Function Name: ArrangeRecords
+
+ Description:
+   CM_ARRANGE: gives the top level records icon positions in rows as
+   wide as the container, top to bottom.
+----------------------------------------------------------------------*/
+static VOID ArrangeRecords (PHOSTCNR pCnr, LONG cxWindow)
+{
+  PCNRNODE     pNode;
+  PRECORDCORE  pRec;
+  LONG         x = 0;
+  LONG         y = 0;
+  LONG         cx;
+
+  if (cxWindow < HOST_CX_ICON * 4)
+  {
+    cxWindow = 640;
+  }
+  for (pNode = pCnr->Root.pFirst; pNode; pNode = pNode->pNext)
+  {
+    cx = ((LONG)pNode->cxText > HOST_CX_ICON) ? (LONG)pNode->cxText :
+                                               HOST_CX_ICON;
+    if ((x) && (x + cx > cxWindow))
+    {
+      x = 0;
+      y -= HOST_CY_ICON + HOST_CY_CHAR * 2;
+    }
+    pRec = RECFROMNODE(pNode);
+    pRec->ptlIcon.x = x + (cx - HOST_CX_ICON) / 2;
+    pRec->ptlIcon.y = y;
+    x += cx + HOST_CX_GAP;
+  }
+}
+
+/*----------------------------------------------------------------------
+ Function Name: QueryRecordFromRect
+
+ Description:
+   CM_QUERYRECORDFROMRECT: returns the next record after pRec, or the
+   first if pRec is CMA_FIRST, that is in a rectangle.  In Icon view
+   that is a record whose icon is in it.  The other views show one
+   record a row, HOST_CY_ICON high, and since the stand-in never
+   scrolls the rectangle is taken to start at the first one.
+----------------------------------------------------------------------*/
+static PRECORDCORE QueryRecordFromRect (PHOSTCNR pCnr, PRECORDCORE pRec,
+                                        PQUERYRECFROMRECT pQuery)
+{
+  PRECTL       prcl = &pQuery->rect;
+  PCNRNODE     pNode;
+  PRECORDCORE  pFound;
+  LONG         cRows;
+  LONG         iRow;
+  BOOL         fAfter = (pRec == (PRECORDCORE)CMA_FIRST);
+
+  if ((pCnr->CnrInfo.flWindowAttr & CV_ICON) &&
+      (!(pCnr->CnrInfo.flWindowAttr & CV_TREE)))
+  {
+    pNode = (fAfter) ? pCnr->Root.pFirst : NODEFROMREC(pRec)->pNext;
+    for (; pNode; pNode = pNode->pNext)
+    {
+      pFound = RECFROMNODE(pNode);
+      if ((pFound->ptlIcon.x < prcl->xRight) &&
+          (pFound->ptlIcon.x + HOST_CX_ICON > prcl->xLeft) &&
+          (pFound->ptlIcon.y < prcl->yTop) &&
+          (pFound->ptlIcon.y + HOST_CY_ICON > prcl->yBottom))
+      {
+        return (pFound);
+      }
+    }
+    return (NULL);
+  }
+
+  cRows = (prcl->yTop - prcl->yBottom + HOST_CY_ICON - 1) / HOST_CY_ICON;
+  for (pNode = pCnr->Root.pFirst, iRow = 0; (pNode) && (iRow < cRows);
+       pNode = NextShownNode (pCnr, pNode), iRow++)
+  {
+    if (fAfter)
+    {
+      return (RECFROMNODE(pNode));
+    }
+    fAfter = (RECFROMNODE(pNode) == pRec);
+  }
+  return (NULL);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: QueryRecord
+
+ Description:
+   CM_QUERYRECORD: returns a record relative to another.
+----------------------------------------------------------------------*/
+static PRECORDCORE QueryRecord (PHOSTCNR pCnr, PRECORDCORE pRec,
+                                ULONG cmd)
+{
+  PCNRNODE  pNode = (pRec) ? NODEFROMREC(pRec) : NULL;
+  PCNRNODE  pFound;
+
+  switch (cmd)
+  {
+    case CMA_FIRST:
+      pFound = pCnr->Root.pFirst;
+    break;
+
+    case CMA_LAST:
+      pFound = pCnr->Root.pLast;
+    break;
+
+    case CMA_NEXT:
+      pFound = (pNode) ? pNode->pNext : NULL;
+    break;
+
+    case CMA_PREV:
+      pFound = (pNode) ? pNode->pPrev : NULL;
+    break;
+
+    case CMA_FIRSTCHILD:
+      pFound = (pNode) ? pNode->pFirst : NULL;
+    break;
+
+    case CMA_LASTCHILD:
+      pFound = (pNode) ? pNode->pLast : NULL;
+    break;
+
+    case CMA_PARENT:
+      pFound = ((pNode) && (pNode->pParent != &pCnr->Root)) ?
+               pNode->pParent : NULL;
+    break;
+
+    default:
+      return ((PRECORDCORE)-1);
+  }
+  return ((pFound) ? RECFROMNODE(pFound) : NULL);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: FieldInfoMsg
+
+ Description:
+   Handles the CM_*DETAILFIELDINFO messages.  The container keeps its
+   columns in a list linked through pNextFieldInfo.
+----------------------------------------------------------------------*/
+static MRESULT FieldInfoMsg (PHOSTCNR pCnr, ULONG msg,
+                             MPARAM mp1, MPARAM mp2)
+{
+  PFIELDINFOINSERT  pInsert;
+  PFIELDINFO        pFieldInfo;
+  PFIELDINFO        pFieldLast;
+  PFIELDINFO       *ppFieldInfo;
+  PFIELDINFO       *apFieldInfos;
+  ULONG             c;
+  ULONG             i;
+
+  switch (msg)
+  {
+    case CM_ALLOCDETAILFIELDINFO:
+      pFieldInfo = NULL;
+      for (i = SHORT1FROMMP(mp1); i; i--)
+      {
+        pFieldLast = calloc (1, sizeof(FIELDINFO));
+        if (!pFieldLast)
+        {
+          while (pFieldInfo)
+          {
+            pFieldLast = pFieldInfo->pNextFieldInfo;
+            free (pFieldInfo);
+            pFieldInfo = pFieldLast;
+          }
+          return (NULL);
+        }
+        pFieldLast->cb = sizeof(FIELDINFO);
+        pFieldLast->pNextFieldInfo = pFieldInfo;
+        pFieldInfo = pFieldLast;
+      }
+      return (pFieldInfo);
+
+    case CM_INSERTDETAILFIELDINFO:
+      pInsert = PVOIDFROMMP(mp2);
+      pFieldInfo = PVOIDFROMMP(mp1);
+      if ((!pFieldInfo) || (!pInsert->cFieldInfoInsert))
+      {
+        return (NULL);
+      }
+      for (pFieldLast = pFieldInfo, i = 1; i < pInsert->cFieldInfoInsert;
+           i++)
+      {
+        pFieldLast = pFieldLast->pNextFieldInfo;
+      }
+      if (pInsert->pFieldInfoOrder == (PFIELDINFO)CMA_FIRST)
+      {
+        ppFieldInfo = &pCnr->pFieldInfo;
+      }
+      else if (pInsert->pFieldInfoOrder == (PFIELDINFO)CMA_END)
+      {
+        for (ppFieldInfo = &pCnr->pFieldInfo; *ppFieldInfo;
+             ppFieldInfo = &(*ppFieldInfo)->pNextFieldInfo)
+        {
+        }
+      }
+      else
+      {
+        ppFieldInfo = &pInsert->pFieldInfoOrder->pNextFieldInfo;
+      }
+      pFieldLast->pNextFieldInfo = *ppFieldInfo;
+      *ppFieldInfo = pFieldInfo;
+      pCnr->CnrInfo.cFields += pInsert->cFieldInfoInsert;
+      return (MRFROMLONG(pCnr->CnrInfo.cFields));
+
+    case CM_QUERYDETAILFIELDINFO:
+      switch (SHORT1FROMMP(mp2))
+      {
+        case CMA_FIRST:
+          return (pCnr->pFieldInfo);
+
+        case CMA_NEXT:
+          pFieldInfo = PVOIDFROMMP(mp1);
+          return ((pFieldInfo) ? pFieldInfo->pNextFieldInfo : NULL);
+
+        case CMA_LAST:
+          for (pFieldInfo = pCnr->pFieldInfo;
+               (pFieldInfo) && (pFieldInfo->pNextFieldInfo);
+               pFieldInfo = pFieldInfo->pNextFieldInfo)
+          {
+          }
+          return (pFieldInfo);
+      }
+      return ((MRESULT)-1);
+
+    case CM_REMOVEDETAILFIELDINFO:
+      apFieldInfos = PVOIDFROMMP(mp1);
+      c = SHORT1FROMMP(mp2);
+      for (ppFieldInfo = &pCnr->pFieldInfo; *ppFieldInfo; )
+      {
+        pFieldInfo = *ppFieldInfo;
+        for (i = 0; (i < c) && (apFieldInfos[i] != pFieldInfo); i++)
+        {
+        }
+        if ((c) && (i == c))
+        {
+          ppFieldInfo = &pFieldInfo->pNextFieldInfo;
+          continue;
+        }
+        *ppFieldInfo = pFieldInfo->pNextFieldInfo;
+        pCnr->CnrInfo.cFields--;
+        if (SHORT2FROMMP(mp2) & CMA_FREE)
+        {
+          free (pFieldInfo);
+        }
+      }
+      return (MRFROMLONG(pCnr->CnrInfo.cFields));
+
+    case CM_FREEDETAILFIELDINFO:
+      apFieldInfos = PVOIDFROMMP(mp1);
+      for (i = 0; i < SHORT1FROMMP(mp2); i++)
+      {
+        free (apFieldInfos[i]);
+      }
+      return ((MRESULT)TRUE);
+  }
+  return (NULL);
+}
+
+/*----------------------------------------------------------------------
+ Function Name: CnrWndProc
+
+ Description:
+   The window procedure of the container stand-in.
+----------------------------------------------------------------------*/
+static MRESULT CnrWndProc (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2)
+{
+  PHOSTCNR       pCnr = WinQueryWindowPtr (hwnd, QWL_USER);
+  PHOSTWND       pWnd;
+  PCNRINFO       pCnrInfo;
+  PCNRNODE       pNode;
+  PCNRNODE      *apNodes;
+  PRECORDCORE   *apRecs;
+  PRECORDCORE    pRec;
+  PRECTL         prcl;
+  NOTIFYRECORDEMPHASIS NotifyEmphasis;
+  ULONG          fl;
+  ULONG          i;
+
+  switch (msg)
+  {
+    case WM_CREATE:
+      pCnr = calloc (1, sizeof(HOSTCNR));
+      if (!pCnr)
+      {
+        return ((MRESULT)TRUE);
+      }
+      pCnr->CnrInfo.cb = sizeof(CNRINFO);
+      pCnr->CnrInfo.flWindowAttr = CV_ICON;
+      WinSetWindowPtr (hwnd, QWL_USER, pCnr);
+      return ((MRESULT)FALSE);
+
+    case WM_DESTROY:
+      if (pCnr)
+      {
+        RemoveRecords (pCnr, NULL, 0, CMA_FREE);
+        FieldInfoMsg (pCnr, CM_REMOVEDETAILFIELDINFO, NULL,
+                      MPFROM2SHORT(0, CMA_FREE));
+        free (pCnr);
+        WinSetWindowPtr (hwnd, QWL_USER, NULL);
+      }
+      return (NULL);
+
+    case CM_ALLOCRECORD:
+      return (AllocRecords (LONGFROMMP(mp1), LONGFROMMP(mp2)));
+
+    case CM_FREERECORD:
+      apRecs = PVOIDFROMMP(mp1);
+      for (i = 0; i < SHORT1FROMMP(mp2); i++)
+      {
+        if (NODEFROMREC(apRecs[i])->pParent)
+        {
+          return ((MRESULT)FALSE);  /* Still inserted */
+        }
+        FreeNodes (pCnr, NODEFROMREC(apRecs[i]));
+      }
+      return ((MRESULT)TRUE);
+
+    case CM_INSERTRECORD:
+      return (MRFROMLONG(InsertRecords (pCnr, PVOIDFROMMP(mp1),
+                                        PVOIDFROMMP(mp2))));
+
+    case CM_REMOVERECORD:
+      return (MRFROMLONG(RemoveRecords (pCnr, PVOIDFROMMP(mp1),
+                                        SHORT1FROMMP(mp2),
+                                        SHORT2FROMMP(mp2))));
+
+    case CM_QUERYRECORD:
+      return (QueryRecord (pCnr, PVOIDFROMMP(mp1), SHORT1FROMMP(mp2)));
+
+    case CM_INVALIDATERECORD:
+      /* Only changed text costs anything without painting. */
+      if (SHORT2FROMMP(mp2) & CMA_TEXTCHANGED)
+      {
+        apRecs = PVOIDFROMMP(mp1);
+        if (!SHORT1FROMMP(mp2))
+        {
+          for (pNode = pCnr->Root.pFirst; pNode;
+               pNode = NextNode (pCnr, pNode))
+          {
+            MeasureRecord (pNode);
+          }
+        }
+        for (i = 0; i < SHORT1FROMMP(mp2); i++)
+        {
+          MeasureRecord (NODEFROMREC(apRecs[i]));
+        }
+      }
+      return ((MRESULT)TRUE);
+
+    case CM_SORTRECORD:
+      apNodes = malloc ((pCnr->Root.cRecs + 1) * sizeof(PCNRNODE));
+      if (!apNodes)
+      {
+        return ((MRESULT)FALSE);
+      }
+      pfnSortCompare = (PFNRECCOMPARE)PVOIDFROMMP(mp1);
+      pSortStorage = PVOIDFROMMP(mp2);
+      SortChildren (&pCnr->Root, apNodes);
+      free (apNodes);
+      return ((MRESULT)TRUE);
+
+    case CM_ARRANGE:
+      pWnd = HostWnd (hwnd);
+      ArrangeRecords (pCnr, pWnd->cx);
+      return ((MRESULT)TRUE);
+
+    case CM_SETCNRINFO:
+      pCnrInfo = PVOIDFROMMP(mp1);
+      fl = LONGFROMMP(mp2);
+      if (fl & CMA_PSORTRECORD)
+      {
+        pCnr->CnrInfo.pSortRecord = pCnrInfo->pSortRecord;
+      }
+      if (fl & CMA_PFIELDINFOLAST)
+      {
+        pCnr->CnrInfo.pFieldInfoLast = pCnrInfo->pFieldInfoLast;
+      }
+      if (fl & CMA_PFIELDINFOOBJECT)
+      {
+        pCnr->CnrInfo.pFieldInfoObject = pCnrInfo->pFieldInfoObject;
+      }
+      if (fl & CMA_CNRTITLE)
+      {
+        pCnr->CnrInfo.pszCnrTitle = pCnrInfo->pszCnrTitle;
+      }
+      if (fl & CMA_FLWINDOWATTR)
+      {
+        pCnr->CnrInfo.flWindowAttr = pCnrInfo->flWindowAttr;
+      }
+      if (fl & CMA_PTLORIGIN)
+      {
+        pCnr->CnrInfo.ptlOrigin = pCnrInfo->ptlOrigin;
+      }
+      if (fl & CMA_DELTA)
+      {
+        pCnr->CnrInfo.cDelta = pCnrInfo->cDelta;
+      }
+      if (fl & CMA_XVERTSPLITBAR)
+      {
+        pCnr->CnrInfo.xVertSplitbar = pCnrInfo->xVertSplitbar;
+      }
+      return ((MRESULT)TRUE);
+
+    case CM_QUERYCNRINFO:
+      pCnr->CnrInfo.cRecords = pCnr->Root.cRecs;
+      i = SHORT1FROMMP(mp2);
+      if (i > sizeof(CNRINFO))
+      {
+        i = sizeof(CNRINFO);
+      }
+      memcpy (PVOIDFROMMP(mp1), &pCnr->CnrInfo, i);
+      return (MRFROMLONG(i));
+
+    case CM_ALLOCDETAILFIELDINFO:
+    case CM_INSERTDETAILFIELDINFO:
+    case CM_QUERYDETAILFIELDINFO:
+    case CM_REMOVEDETAILFIELDINFO:
+    case CM_FREEDETAILFIELDINFO:
+      return (FieldInfoMsg (pCnr, msg, mp1, mp2));
+
+    case CM_EXPANDTREE:
+    case CM_COLLAPSETREE:
+      pRec = PVOIDFROMMP(mp1);
+      if (!pRec)
+      {
+        return ((MRESULT)FALSE);
+      }
+      pRec->flRecordAttr &= ~(CRA_EXPANDED | CRA_COLLAPSED);
+      pRec->flRecordAttr |= (msg == CM_EXPANDTREE) ? CRA_EXPANDED :
+                                                     CRA_COLLAPSED;
+      pWnd = HostWnd (hwnd);
+      WinSendMsg (pWnd->hwndOwner, WM_CONTROL,
+                  MPFROM2SHORT(pWnd->id, (msg == CM_EXPANDTREE) ?
+                                         CN_EXPANDTREE : CN_COLLAPSETREE),
+                  MPFROMP(pRec));
+      return ((MRESULT)TRUE);
+
+    case CM_SETRECORDEMPHASIS:
+      pRec = PVOIDFROMMP(mp1);
+      fl = SHORT2FROMMP(mp2);
+      if (!pRec)
+      {
+        return ((MRESULT)FALSE);
+      }
+      if ((fl & CRA_SELECTED) && (NODEFROMREC(pRec)->pParent))
+      {
+        pCnr->cSelected -= (pRec->flRecordAttr & CRA_SELECTED) ? 1 : 0;
+        pCnr->cSelected += (SHORT1FROMMP(mp2)) ? 1 : 0;
+      }
+      if (SHORT1FROMMP(mp2))
+      {
+        pRec->flRecordAttr |= fl;
+      }
+      else
+      {
+        pRec->flRecordAttr &= ~fl;
+      }
+
+      /* The owner is told, as PM tells it. */
+      pWnd = HostWnd (hwnd);
+      NotifyEmphasis.hwndCnr = hwnd;
+      NotifyEmphasis.pRecord = pRec;
+      NotifyEmphasis.fEmphasisMask = fl;
+      WinSendMsg (pWnd->hwndOwner, WM_CONTROL,
+                  MPFROM2SHORT(pWnd->id, CN_EMPHASIS),
+                  MPFROMP(&NotifyEmphasis));
+      return ((MRESULT)TRUE);
+
+    case CM_QUERYRECORDEMPHASIS:
+      fl = SHORT1FROMMP(mp2);
+      if ((fl == CRA_SELECTED) && (!pCnr->cSelected))
+      {
+        return (NULL);
+      }
+      pNode = (PVOIDFROMMP(mp1) == (PVOID)CMA_FIRST) ? pCnr->Root.pFirst :
+              NextNode (pCnr, NODEFROMREC(PVOIDFROMMP(mp1)));
+      for (; pNode; pNode = NextNode (pCnr, pNode))
+      {
+        if ((RECFROMNODE(pNode)->flRecordAttr & fl) == fl)
+        {
+          return (RECFROMNODE(pNode));
+        }
+      }
+      return (NULL);
+
+    case CM_QUERYRECORDRECT:
+      prcl = PVOIDFROMMP(mp1);
+      pRec = ((PQUERYRECORDRECT)PVOIDFROMMP(mp2))->pRecord;
+      pNode = NODEFROMREC(pRec);
+      prcl->xLeft = pRec->ptlIcon.x;
+      prcl->yBottom = pRec->ptlIcon.y - HOST_CY_CHAR;
+      prcl->xRight = pRec->ptlIcon.x +
+                     (((LONG)pNode->cxText > HOST_CX_ICON) ?
+                      (LONG)pNode->cxText : HOST_CX_ICON);
+      prcl->yTop = pRec->ptlIcon.y + HOST_CY_ICON;
+      return ((MRESULT)TRUE);
+
+    case CM_QUERYRECORDFROMRECT:
+      return (QueryRecordFromRect (pCnr, PVOIDFROMMP(mp1),
+                                   PVOIDFROMMP(mp2)));
+
+    case CM_QUERYVIEWPORTRECT:
+      return (MRFROMLONG(WinQueryWindowRect (hwnd, PVOIDFROMMP(mp1))));
+
+    case CM_SCROLLWINDOW:
+      /* Nothing moves, but the owner is told as PM tells it. */
+      pWnd = HostWnd (hwnd);
+      WinSendMsg (pWnd->hwndOwner, WM_CONTROL,
+                  MPFROM2SHORT(pWnd->id, CN_SCROLL), mp2);
+      return ((MRESULT)TRUE);
+  }
+  return (NULL);
+}
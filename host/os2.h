@@ -0,0 +1,532 @@
+/* ===================================================================*/
+/*            Basic Container Sample - host os2.h                     */
+/* ------------------------------------------------------------------ */
+/*                                                                    */
+/*  Functional Description:                                           */
+/*                                                                    */
+/*    The part of the OS/2 toolkit headers the sample uses, so that   */
+/*    its benchmark can be built with the gcc of a host without       */
+/*    OS/2 (make hostbench).  The functions are implemented by        */
+/*    hostpm.c.  Handles are pointers on the host, so ULONG is the    */
+/*    size of a pointer and not 32 bits as on OS/2.                   */
+/*                                                                    */
+/* ===================================================================*/
+#ifndef HOST_OS2_H
+#define HOST_OS2_H
+
+#include <stddef.h>
+
+/* Base types */
+typedef unsigned long   ULONG;
+typedef long            LONG;
+typedef unsigned short  USHORT;
+typedef short           SHORT;
+typedef unsigned char   UCHAR;
+typedef char            CHAR;
+typedef unsigned char   BYTE;
+typedef int             BOOL;
+typedef void            VOID;
+typedef ULONG           APIRET;
+
+typedef ULONG          *PULONG;
+typedef USHORT         *PUSHORT;
+typedef UCHAR          *PUCHAR;
+typedef BYTE           *PBYTE;
+typedef CHAR           *PCHAR;
+typedef char           *PCH;
+typedef BOOL           *PBOOL;
+typedef void           *PVOID;
+typedef PVOID          *PPVOID;
+typedef unsigned char  *PSZ;
+typedef const unsigned char *PCSZ;
+
+typedef ULONG LHANDLE;
+typedef LHANDLE HWND, HAB, HMQ, HPS, HPOINTER, HFILE, HEV, TID, HMODULE;
+typedef HFILE  *PHFILE;
+typedef HEV    *PHEV;
+typedef TID    *PTID;
+
+typedef void   *MPARAM;
+typedef void   *MRESULT;
+typedef MRESULT (*PFNWP) (HWND, ULONG, MPARAM, MPARAM);
+
+#define EXPENTRY
+#define APIENTRY
+
+#define TRUE        1
+#define FALSE       0
+#define NULLHANDLE  ((LHANDLE)0)
+
+typedef struct _QWORD
+{
+  ULONG  ulLo;
+  ULONG  ulHi;
+} QWORD;
+typedef QWORD *PQWORD;
+
+typedef struct _POINTL
+{
+  LONG  x;
+  LONG  y;
+} POINTL;
+typedef POINTL *PPOINTL;
+
+typedef struct _RECTL
+{
+  LONG  xLeft;
+  LONG  yBottom;
+  LONG  xRight;
+  LONG  yTop;
+} RECTL;
+typedef RECTL *PRECTL;
+
+/* Message parameter packing */
+#define FIELDOFFSET(type,field)  ((ULONG)offsetof(type, field))
+#define MPFROMP(p)               ((MPARAM)(p))
+#define MPFROMHWND(hwnd)         ((MPARAM)(hwnd))
+#define MPFROMLONG(l)            ((MPARAM)(ULONG)(l))
+#define MPFROMSHORT(s)           ((MPARAM)(ULONG)(USHORT)(s))
+#define MPFROM2SHORT(s1,s2)      ((MPARAM)((ULONG)(USHORT)(s1) | \
+                                           ((ULONG)(USHORT)(s2) << 16)))
+#define MRFROMLONG(l)            ((MRESULT)(ULONG)(l))
+#define LONGFROMMP(mp)           ((ULONG)(mp))
+#define LONGFROMMR(mr)           ((ULONG)(mr))
+#define PVOIDFROMMP(mp)          ((PVOID)(mp))
+#define PVOIDFROMMR(mr)          ((PVOID)(mr))
+#define HWNDFROMMP(mp)           ((HWND)(mp))
+#define SHORT1FROMMP(mp)         ((USHORT)(ULONG)(mp))
+#define SHORT2FROMMP(mp)         ((USHORT)((ULONG)(mp) >> 16))
+#define SHORT1FROMMR(mr)         ((USHORT)(ULONG)(mr))
+
+/* Window manager */
+#define HWND_DESKTOP    ((HWND)1)
+#define HWND_OBJECT     ((HWND)2)
+#define HWND_TOP        ((HWND)3)
+
+#define WS_VISIBLE      0x80000000L
+
+#define FCF_TITLEBAR       0x00000001L
+#define FCF_SYSMENU        0x00000002L
+#define FCF_MENU           0x00000004L
+#define FCF_SIZEBORDER     0x00000008L
+#define FCF_MINMAX         0x00000030L
+#define FCF_ICON           0x00004000L
+#define FCF_SHELLPOSITION  0x00400000L
+
+#define WM_CREATE       0x0001
+#define WM_DESTROY      0x0002
+#define WM_SIZE         0x0007
+#define WM_COMMAND      0x0020
+#define WM_CONTROL      0x0030
+#define WM_INITDLG      0x003B
+#define WM_PAINT        0x0023
+#define WM_TIMER        0x0024
+#define WM_QUIT         0x002A
+#define WM_USER         0x1000
+
+#define CMDSRC_MENU     2
+#define PM_REMOVE       1
+#define PM_NOREMOVE     0
+#define QWL_USER        0
+#define QW_PARENT       5
+#define QW_OWNER        4
+#define SWP_SIZE        0x0001
+#define SWP_MOVE        0x0002
+#define SYSCLR_BACKGROUND  (-19L)
+#define FID_MENU        0x8005
+#define FID_CLIENT      0x8008
+#define DID_OK          1
+#define DID_CANCEL      2
+#define WA_WARNING      0
+#define EN_CHANGE       0x0004
+#define EM_SETTEXTLIMIT 0x0143
+#define MM_SETITEMTEXT  0x018E
+
+typedef struct _QMSG
+{
+  HWND    hwnd;
+  ULONG   msg;
+  MPARAM  mp1;
+  MPARAM  mp2;
+  ULONG   time;
+  POINTL  ptl;
+  ULONG   reserved;
+} QMSG;
+typedef QMSG *PQMSG;
+
+typedef struct _SWP
+{
+  ULONG  fl;
+  LONG   cy;
+  LONG   cx;
+  LONG   y;
+  LONG   x;
+  HWND   hwndInsertBehind;
+  HWND   hwnd;
+  ULONG  ulReserved1;
+  ULONG  ulReserved2;
+} SWP;
+typedef SWP *PSWP;
+
+HAB      WinInitialize (ULONG flOptions);
+BOOL     WinTerminate (HAB hab);
+HMQ      WinCreateMsgQueue (HAB hab, LONG cmsg);
+BOOL     WinDestroyMsgQueue (HMQ hmq);
+BOOL     WinRegisterClass (HAB hab, PCSZ pszClassName, PFNWP pfnWndProc,
+                           ULONG flStyle, ULONG cbWindowData);
+HWND     WinCreateStdWindow (HWND hwndParent, ULONG flStyle,
+                             ULONG *pflCreateFlags, PCSZ pszClientClass,
+                             PCSZ pszTitle, ULONG flClientStyle,
+                             HMODULE hmod, ULONG idResources,
+                             HWND *phwndClient);
+HWND     WinCreateWindow (HWND hwndParent, PCSZ pszClass, PCSZ pszName,
+                          ULONG flStyle, LONG x, LONG y, LONG cx, LONG cy,
+                          HWND hwndOwner, HWND hwndInsertBehind, ULONG id,
+                          PVOID pCtlData, PVOID pPresParams);
+BOOL     WinDestroyWindow (HWND hwnd);
+HWND     WinWindowFromID (HWND hwndParent, ULONG id);
+HWND     WinQueryWindow (HWND hwnd, LONG cmd);
+HAB      WinQueryAnchorBlock (HWND hwnd);
+PVOID    WinQueryWindowPtr (HWND hwnd, LONG index);
+BOOL     WinSetWindowPtr (HWND hwnd, LONG index, PVOID p);
+BOOL     WinQueryWindowRect (HWND hwnd, PRECTL prcl);
+BOOL     WinSetMultWindowPos (HAB hab, PSWP pswp, ULONG cswp);
+BOOL     WinSetFocus (HWND hwndDesktop, HWND hwndFocus);
+BOOL     WinUpdateWindow (HWND hwnd);
+MRESULT  WinSendMsg (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2);
+BOOL     WinPostMsg (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2);
+BOOL     WinGetMsg (HAB hab, PQMSG pqmsg, HWND hwndFilter,
+                    ULONG msgFilterFirst, ULONG msgFilterLast);
+BOOL     WinPeekMsg (HAB hab, PQMSG pqmsg, HWND hwndFilter,
+                     ULONG msgFilterFirst, ULONG msgFilterLast, ULONG fl);
+MRESULT  WinDispatchMsg (HAB hab, PQMSG pqmsg);
+MRESULT  WinDefWindowProc (HWND hwnd, ULONG msg, MPARAM mp1, MPARAM mp2);
+ULONG    WinStartTimer (HAB hab, HWND hwnd, ULONG idTimer, ULONG dtTimeout);
+BOOL     WinStopTimer (HAB hab, HWND hwnd, ULONG idTimer);
+HPS      WinBeginPaint (HWND hwnd, HPS hps, PRECTL prclPaint);
+BOOL     WinFillRect (HPS hps, PRECTL prcl, LONG lColor);
+BOOL     WinEndPaint (HPS hps);
+HPOINTER WinLoadPointer (HWND hwndDesktop, HMODULE hmod, ULONG idres);
+BOOL     WinDestroyPointer (HPOINTER hptr);
+ULONG    WinUpperChar (HAB hab, ULONG idcp, ULONG idcc, ULONG c);
+BOOL     WinAlarm (HWND hwndDesktop, ULONG rgfType);
+HWND     WinLoadDlg (HWND hwndParent, HWND hwndOwner, PFNWP pfnDlgProc,
+                     HMODULE hmod, ULONG idDlg, PVOID pCreateParams);
+MRESULT  WinDefDlgProc (HWND hwndDlg, ULONG msg, MPARAM mp1, MPARAM mp2);
+ULONG    WinQueryDlgItemText (HWND hwndDlg, ULONG idItem, LONG cchBufferMax,
+                              PSZ pchBuffer);
+MRESULT  WinSendDlgItemMsg (HWND hwndDlg, ULONG idItem, ULONG msg,
+                            MPARAM mp1, MPARAM mp2);
+
+/* Container */
+#define WC_CONTAINER    ((PCSZ)0xFFFF0025L)
+
+#define CCS_EXTENDSEL       0x00000001L
+#define CCS_SINGLESEL       0x00000004L
+#define CCS_READONLY        0x00000010L
+#define CCS_MINIRECORDCORE  0x00000020L
+
+#define CM_ALLOCDETAILFIELDINFO   0x0330
+#define CM_ALLOCRECORD            0x0331
+#define CM_ARRANGE                0x0332
+#define CM_COLLAPSETREE           0x0334
+#define CM_EXPANDTREE             0x0337
+#define CM_FREEDETAILFIELDINFO    0x0338
+#define CM_FREERECORD             0x0339
+#define CM_INSERTDETAILFIELDINFO  0x033B
+#define CM_INSERTRECORD           0x033C
+#define CM_INVALIDATERECORD       0x033E
+#define CM_QUERYCNRINFO           0x0340
+#define CM_QUERYDETAILFIELDINFO   0x0341
+#define CM_QUERYRECORD            0x0344
+#define CM_QUERYRECORDEMPHASIS    0x0345
+#define CM_QUERYRECORDFROMRECT    0x0346
+#define CM_QUERYRECORDRECT        0x0347
+#define CM_QUERYVIEWPORTRECT      0x0348
+#define CM_REMOVEDETAILFIELDINFO  0x0349
+#define CM_REMOVERECORD           0x034A
+#define CM_SCROLLWINDOW           0x034C
+#define CM_SETCNRINFO             0x034E
+#define CM_SETRECORDEMPHASIS      0x034F
+#define CM_SORTRECORD             0x0350
+
+#define CN_EMPHASIS       0x006A
+#define CN_EXPANDTREE     0x006B
+#define CN_COLLAPSETREE   0x006C
+#define CN_SCROLL         0x006E
+
+/* Record positions for CM_QUERYRECORD and CM_INSERTRECORD */
+#define CMA_TOP           0x0001L
+#define CMA_BOTTOM        0x0002L
+#define CMA_LEFT          0x0004L
+#define CMA_RIGHT         0x0008L
+#define CMA_FIRST         0x0010L
+#define CMA_LAST          0x0020L
+#define CMA_END           0x0040L
+#define CMA_PREV          0x0080L
+#define CMA_NEXT          0x0100L
+#define CMA_FIRSTCHILD    0x1000L
+#define CMA_LASTCHILD     0x2000L
+#define CMA_PARENT        0x4000L
+#define CMA_ITEMORDER     0x0001L
+
+/* CM_SETCNRINFO fields */
+#define CMA_PSORTRECORD      0x0001L
+#define CMA_PFIELDINFOLAST   0x0002L
+#define CMA_PFIELDINFOOBJECT 0x0004L
+#define CMA_CNRTITLE         0x0008L
+#define CMA_FLWINDOWATTR     0x0010L
+#define CMA_PTLORIGIN        0x0020L
+#define CMA_DELTA            0x0040L
+#define CMA_XVERTSPLITBAR    0x0800L
+
+/* CM_REMOVERECORD and CM_INVALIDATERECORD flags */
+#define CMA_FREE          0x0001L
+#define CMA_INVALIDATE    0x0002L
+#define CMA_ERASE         0x0010L
+#define CMA_REPOSITION    0x0020L
+#define CMA_TEXTCHANGED   0x0040L
+#define CMA_NOREPOSITION  0x0080L
+
+/* CM_QUERYRECORDRECT, CM_QUERYVIEWPORTRECT and CM_SCROLLWINDOW */
+#define CMA_ICON          0x0001L
+#define CMA_TEXT          0x0002L
+#define CMA_WINDOW        0x0001L
+#define CMA_WORKSPACE     0x0002L
+#define CMA_VERTICAL      0x0001L
+#define CMA_HORIZONTAL    0x0002L
+
+/* QUERYRECFROMRECT fsSearch */
+#define CMA_PARTIAL       0x0008L
+#define CMA_COMPLETE      0x0010L
+
+#define CRA_SELECTED      0x00000001L
+#define CRA_CURSORED      0x00000004L
+#define CRA_EXPANDED      0x00004000L
+#define CRA_COLLAPSED     0x00008000L
+
+#define CV_TEXT           0x00000001L
+#define CV_NAME           0x00000002L
+#define CV_ICON           0x00000004L
+#define CV_DETAIL         0x00000008L
+#define CV_FLOW           0x00000010L
+#define CV_TREE           0x00000040L
+#define CA_CONTAINERTITLE     0x00000200L
+#define CA_TITLESEPARATOR     0x00004000L
+#define CA_DETAILSVIEWTITLES  0x00000800L
+#define CA_TREELINE           0x00400000L
+
+#define CFA_BITMAPORICON  0x00000001L
+#define CFA_STRING        0x00000004L
+#define CFA_ULONG         0x00000008L
+#define CFA_DATE          0x00000010L
+#define CFA_TIME          0x00000020L
+#define CFA_SEPARATOR     0x00000200L
+#define CFA_HORZSEPARATOR 0x00000400L
+#define CFA_CENTER        0x00002000L
+#define CFA_RIGHT         0x00004000L
+
+typedef struct _CDATE
+{
+  UCHAR   day;
+  UCHAR   month;
+  USHORT  year;
+} CDATE;
+
+typedef struct _CTIME
+{
+  UCHAR   hours;
+  UCHAR   minutes;
+  UCHAR   seconds;
+  UCHAR   ucReserved;
+} CTIME;
+
+typedef struct _RECORDCORE
+{
+  ULONG     cb;
+  ULONG     flRecordAttr;
+  POINTL    ptlIcon;
+  struct _RECORDCORE *preccNextRecord;
+  PSZ       pszIcon;
+  HPOINTER  hptrIcon;
+} RECORDCORE;
+typedef RECORDCORE *PRECORDCORE;
+
+typedef struct _MINIRECORDCORE
+{
+  ULONG     cb;
+  ULONG     flRecordAttr;
+  POINTL    ptlIcon;
+  struct _MINIRECORDCORE *preccNextRecord;
+  PSZ       pszIcon;
+  HPOINTER  hptrIcon;
+} MINIRECORDCORE;
+typedef MINIRECORDCORE *PMINIRECORDCORE;
+
+typedef struct _RECORDINSERT
+{
+  ULONG        cb;
+  PRECORDCORE  pRecordOrder;
+  PRECORDCORE  pRecordParent;
+  ULONG        fInvalidateRecord;
+  ULONG        zOrder;
+  ULONG        cRecordsInsert;
+} RECORDINSERT;
+typedef RECORDINSERT *PRECORDINSERT;
+
+typedef struct _FIELDINFO
+{
+  ULONG     cb;
+  ULONG     flData;
+  ULONG     flTitle;
+  PVOID     pTitleData;
+  ULONG     offStruct;
+  PVOID     pUserData;
+  struct _FIELDINFO *pNextFieldInfo;
+  ULONG     cxWidth;
+} FIELDINFO;
+typedef FIELDINFO *PFIELDINFO;
+
+typedef struct _FIELDINFOINSERT
+{
+  ULONG       cb;
+  PFIELDINFO  pFieldInfoOrder;
+  ULONG       fInvalidateFieldInfo;
+  ULONG       cFieldInfoInsert;
+} FIELDINFOINSERT;
+typedef FIELDINFOINSERT *PFIELDINFOINSERT;
+
+typedef struct _CNRINFO
+{
+  ULONG       cb;
+  PVOID       pSortRecord;
+  PFIELDINFO  pFieldInfoLast;
+  PFIELDINFO  pFieldInfoObject;
+  PSZ         pszCnrTitle;
+  ULONG       flWindowAttr;
+  POINTL      ptlOrigin;
+  ULONG       cDelta;
+  ULONG       cRecords;
+  LONG        slBitmapOrIcon;
+  LONG        slTreeBitmapOrIcon;
+  ULONG       hbmExpanded;
+  ULONG       hbmCollapsed;
+  HPOINTER    hptrExpanded;
+  HPOINTER    hptrCollapsed;
+  LONG        cyLineSpacing;
+  LONG        cxTreeIndent;
+  LONG        cxTreeLine;
+  ULONG       cFields;
+  LONG        xVertSplitbar;
+} CNRINFO;
+typedef CNRINFO *PCNRINFO;
+
+typedef struct _QUERYRECORDRECT
+{
+  ULONG        cb;
+  PRECORDCORE  pRecord;
+  ULONG        fRightSplitWindow;
+  ULONG        fsExtent;
+} QUERYRECORDRECT;
+typedef QUERYRECORDRECT *PQUERYRECORDRECT;
+
+typedef struct _NOTIFYRECORDEMPHASIS
+{
+  HWND         hwndCnr;
+  PRECORDCORE  pRecord;
+  ULONG        fEmphasisMask;
+} NOTIFYRECORDEMPHASIS;
+typedef NOTIFYRECORDEMPHASIS *PNOTIFYRECORDEMPHASIS;
+
+typedef struct _QUERYRECFROMRECT
+{
+  ULONG        cb;
+  RECTL        rect;
+  ULONG        fsSearch;
+} QUERYRECFROMRECT;
+typedef QUERYRECFROMRECT *PQUERYRECFROMRECT;
+
+typedef SHORT (APIENTRY *PFNRECCOMPARE) (PRECORDCORE p1, PRECORDCORE p2,
+                                         PVOID pStorage);
+
+/* Files */
+#define FILE_NORMAL                    0x0000
+#define FIL_STANDARD                   1
+#define OPEN_ACTION_FAIL_IF_NEW        0x0000
+#define OPEN_ACTION_OPEN_IF_EXISTS     0x0001
+#define OPEN_ACTION_REPLACE_IF_EXISTS  0x0002
+#define OPEN_ACTION_CREATE_IF_NEW      0x0010
+#define OPEN_ACCESS_READONLY           0x0000
+#define OPEN_ACCESS_WRITEONLY          0x0001
+#define OPEN_ACCESS_READWRITE          0x0002
+#define OPEN_SHARE_DENYREADWRITE       0x0010
+#define OPEN_SHARE_DENYWRITE           0x0020
+#define OPEN_FLAGS_SEQUENTIAL          0x0100
+
+typedef struct _FDATE
+{
+  USHORT  day   : 5;
+  USHORT  month : 4;
+  USHORT  year  : 7;
+} FDATE;
+
+typedef struct _FTIME
+{
+  USHORT  twosecs : 5;
+  USHORT  minutes : 6;
+  USHORT  hours   : 5;
+} FTIME;
+
+typedef struct _FILESTATUS3
+{
+  FDATE  fdateCreation;
+  FTIME  ftimeCreation;
+  FDATE  fdateLastAccess;
+  FTIME  ftimeLastAccess;
+  FDATE  fdateLastWrite;
+  FTIME  ftimeLastWrite;
+  ULONG  cbFile;
+  ULONG  cbFileAlloc;
+  ULONG  attrFile;
+} FILESTATUS3;
+
+APIRET DosOpen (PCSZ pszFileName, PHFILE phf, PULONG pulAction,
+                ULONG cbFile, ULONG ulAttribute, ULONG fsOpenFlags,
+                ULONG fsOpenMode, PVOID peaop2);
+APIRET DosRead (HFILE hf, PVOID pBuffer, ULONG cbRead, PULONG pcbActual);
+APIRET DosWrite (HFILE hf, PVOID pBuffer, ULONG cbWrite, PULONG pcbActual);
+APIRET DosClose (HFILE hf);
+APIRET DosQueryFileInfo (HFILE hf, ULONG ulInfoLevel, PVOID pInfo,
+                         ULONG cbInfoBuf);
+APIRET DosQueryPathInfo (PCSZ pszPathName, ULONG ulInfoLevel, PVOID pInfo,
+                         ULONG cbInfoBuf);
+APIRET DosDelete (PCSZ pszFile);
+
+/* Memory, timers and system information */
+#define PAG_READ         0x0001
+#define PAG_WRITE        0x0002
+#define PAG_COMMIT       0x0010
+#define QSV_TOTAVAILMEM  20
+
+APIRET DosAllocMem (PPVOID ppb, ULONG cb, ULONG flag);
+APIRET DosFreeMem (PVOID pb);
+APIRET DosTmrQueryFreq (PULONG pulTmrFreq);
+APIRET DosTmrQueryTime (PQWORD pqwTmrTime);
+APIRET DosQuerySysInfo (ULONG iStart, ULONG iLast, PVOID pBuf, ULONG cbBuf);
+
+/* Threads and semaphores */
+#define SEM_INDEFINITE_WAIT  ((ULONG)-1)
+#define DCWW_WAIT            0
+
+APIRET DosCreateEventSem (PCSZ pszName, PHEV phev, ULONG flAttr,
+                          BOOL fState);
+APIRET DosCloseEventSem (HEV hev);
+APIRET DosPostEventSem (HEV hev);
+APIRET DosResetEventSem (HEV hev, PULONG pulPostCt);
+APIRET DosWaitEventSem (HEV hev, ULONG ulTimeout);
+APIRET DosWaitThread (PTID ptid, ULONG option);
+APIRET DosSleep (ULONG msec);
+int _beginthread (void (*start) (void *), void *stack, unsigned stack_size,
+                  void *arg);
+
+#endif